@@ -3,6 +3,11 @@
 #include <signal.h>
 #include <filesystem>
 #include <cstdlib>
+#include <charconv>
+#include <format>
+#include <string_view>
+#include <initializer_list>
+#include <utility>
 #include "rtsp_server.hpp"
 
 using namespace paladium;
@@ -16,24 +21,130 @@ void signal_handler(int signal) {
     }
 }
 
-int main(int /*argc*/, char* /*argv*/[]) {
+// Reads a positive integer from the environment, keeping the default when unset
+static std::expected<uint32_t, std::string> env_uint(const char* name, uint32_t fallback) {
+    const char* value = std::getenv(name);
+    if (!value) {
+        return fallback;
+    }
+
+    std::string_view text(value);
+    uint32_t parsed = 0;
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), parsed);
+    if (ec != std::errc() || end != text.data() + text.size() || parsed == 0) {
+        return std::unexpected(std::format("{} must be a positive integer, got '{}'", name, text));
+    }
+    return parsed;
+}
+
+// Applies env_uint to each (variable, field) pair, stopping at the first invalid value
+static std::expected<void, std::string> load_env_uints(
+        std::initializer_list<std::pair<const char*, uint32_t*>> fields) {
+    for (auto [name, field] : fields) {
+        auto parsed = env_uint(name, *field);
+        if (!parsed) {
+            return std::unexpected(parsed.error());
+        }
+        *field = *parsed;
+    }
+    return {};
+}
+
+static std::expected<SourceConfig, std::string> load_source_config() {
+    SourceConfig source;
+
     // Use environment variable or fall back to default
     const char* env_media_file = std::getenv("MEDIA_FILE");
-    const std::string media_file = env_media_file ? env_media_file : "../media/sample.mp4";
+    source.media_file = env_media_file ? env_media_file : "../media/sample.mp4";
+
+    const char* env_source_type = std::getenv("SOURCE_TYPE");
+    const std::string_view source_type = env_source_type ? env_source_type : "file";
+    if (source_type == "file") {
+        source.type = SourceType::File;
+        return source;
+    }
+    if (source_type == "srt") {
+        source.type = SourceType::Srt;
+        auto& srt = source.srt;
+
+        if (const char* uri = std::getenv("SRT_LISTEN_URI")) {
+            srt.uri = uri;
+        }
+        if (auto result = load_env_uints({ { "SRT_LATENCY_MS", &srt.latency_ms },
+                                           { "SRT_BUFFER_MS", &srt.buffer_ms } }); !result) {
+            return std::unexpected(result.error());
+        }
+        return source;
+    }
+    if (source_type != "synthetic") {
+        return std::unexpected(std::format("Unknown SOURCE_TYPE '{}' (expected file, synthetic or srt)", source_type));
+    }
+
+    source.type = SourceType::Synthetic;
+    auto& synthetic = source.synthetic;
+
+    if (const char* resolution = std::getenv("SYNTHETIC_RESOLUTION")) {
+        auto parsed = parse_resolution_class(resolution);
+        if (!parsed) {
+            return std::unexpected(parsed.error());
+        }
+        synthetic.resolution = *parsed;
+    }
+
+    if (auto result = load_env_uints({ { "SYNTHETIC_BITRATE_KBPS", &synthetic.bitrate_kbps },
+                                       { "SYNTHETIC_GOP", &synthetic.gop },
+                                       { "SYNTHETIC_FPS", &synthetic.fps },
+                                       { "SYNTHETIC_STREAMS", &synthetic.streams } }); !result) {
+        return std::unexpected(result.error());
+    }
+
+    // Refuse settings that would need an SPS no H.264 level allows
+    if (auto level = h264_level(synthetic); !level) {
+        return std::unexpected(level.error());
+    }
+
+    const char* env_sei = std::getenv("SYNTHETIC_SEI");
+    synthetic.embed_sei = !env_sei || std::string_view(env_sei) != "0";
+
+    return source;
+}
+
+int main(int /*argc*/, char* /*argv*/[]) {
     const uint16_t rtsp_port = 8555;
 
-    if (!std::filesystem::exists(media_file)) {
-        std::cerr << "Video file not found: " << media_file << std::endl;
+    auto source = load_source_config();
+    if (!source) {
+        std::cerr << "Invalid configuration: " << source.error() << std::endl;
+        return 1;
+    }
+
+    if (source->type == SourceType::File && !std::filesystem::exists(source->media_file)) {
+        std::cerr << "Video file not found: " << source->media_file << std::endl;
         std::cerr << "Run './create_test_video.sh' to create a test video" << std::endl;
+        std::cerr << "or set SOURCE_TYPE=synthetic to stream without a media file" << std::endl;
         return 1;
     }
 
-    auto server = std::make_unique<RTSPServer>(media_file, rtsp_port);
+    if (source->type == SourceType::Synthetic) {
+        const auto& synthetic = source->synthetic;
+        const uint8_t level = *h264_level(synthetic);
+        std::cout << std::format("Synthetic source: {} @ {} fps, {} kbps, level {}.{}, GOP {}, SEI {}, {} stream(s)",
+                                 resolution_class_name(synthetic.resolution), synthetic.fps,
+                                 synthetic.bitrate_kbps, level / 10, level % 10, synthetic.gop,
+                                 synthetic.embed_sei ? "on" : "off", synthetic.streams) << std::endl;
+    }
+
+    if (source->type == SourceType::Srt) {
+        std::cout << std::format("SRT ingest: listening on {} (latency {} ms, buffer {} ms)",
+                                 source->srt.uri, source->srt.latency_ms, source->srt.buffer_ms) << std::endl;
+    }
+
+    auto server = std::make_unique<RTSPServer>(*source, rtsp_port);
     g_server = server.get();
-    
+
     signal(SIGINT, signal_handler);
     signal(SIGTERM, signal_handler);
-    
+
     if (auto result = server->initialize(); !result) {
         std::cerr << "Server failed: " << result.error() << std::endl;
         return 1;
@@ -41,4 +152,4 @@ int main(int /*argc*/, char* /*argv*/[]) {
 
     std::cout << "RTSP server at rtsp://localhost:" << rtsp_port << "/cam1" << std::endl;
     return server->run();
-}
\ No newline at end of file
+}
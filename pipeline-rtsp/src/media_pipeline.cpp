@@ -2,11 +2,111 @@
 #include "../../utils/logger.hpp"
 #include <format>
 #include <filesystem>
+#include <mutex>
+#include <gst/app/gstappsrc.h>
 
 namespace paladium {
 
-MediaPipeline::MediaPipeline(const std::string& media_file) 
-    : media_file_(media_file), factory_(nullptr) {}
+namespace {
+
+// Per-media state for the synthetic source, owned by the appsrc
+struct SyntheticFeed {
+    explicit SyntheticFeed(const SyntheticConfig& config)
+        : source(config), frame_duration(static_cast<GstClockTime>(GST_SECOND) / config.fps) {}
+
+    SyntheticH264Source source;
+    GstClockTime frame_duration;
+    GstClockTime base_time = GST_CLOCK_TIME_NONE;
+    GstClockTime origin = 0;
+    uint64_t frames_since_start = 0;
+
+    // Pacing wait in progress on the streaming thread, unscheduled by
+    // on_synthetic_target_state so unprepare never waits out a frame interval
+    std::mutex wait_lock;
+    GstClockID pending_wait = nullptr;
+    bool stopping = false;
+};
+
+void on_synthetic_need_data(GstAppSrc* appsrc, guint /*length*/, gpointer user_data) {
+    auto* feed = static_cast<SyntheticFeed*>(user_data);
+    GstElement* element = GST_ELEMENT(appsrc);
+    GstClock* clock = gst_element_get_clock(element);
+    GstClockTime base_time = gst_element_get_base_time(element);
+
+    // A new base time means the media was (re)started: continue from the
+    // current running time and open with an IDR so clients can decode
+    if (base_time != feed->base_time) {
+        feed->base_time = base_time;
+        feed->origin = clock ? gst_clock_get_time(clock) - base_time : 0;
+        feed->frames_since_start = 0;
+        feed->source.force_keyframe();
+    }
+
+    GstClockTime pts = feed->origin + feed->frames_since_start * feed->frame_duration;
+    ++feed->frames_since_start;
+
+    // Live pacing: hold each frame until its running time, like a capture device
+    if (clock) {
+        GstClockID id = gst_clock_new_single_shot_id(clock, base_time + pts);
+        gst_object_unref(clock);
+
+        {
+            std::lock_guard lock(feed->wait_lock);
+            if (feed->stopping) {
+                gst_clock_id_unref(id);
+                return;
+            }
+            feed->pending_wait = id;
+        }
+
+        GstClockReturn wait_result = gst_clock_id_wait(id, nullptr);
+
+        {
+            std::lock_guard lock(feed->wait_lock);
+            feed->pending_wait = nullptr;
+        }
+        gst_clock_id_unref(id);
+
+        if (wait_result == GST_CLOCK_UNSCHEDULED) {
+            return;
+        }
+    }
+
+    auto au = feed->source.next_access_unit(g_get_real_time());
+    GstBuffer* buffer = gst_buffer_new_memdup(au.data.data(), au.data.size());
+    GST_BUFFER_PTS(buffer) = pts;
+    GST_BUFFER_DTS(buffer) = pts;
+    GST_BUFFER_DURATION(buffer) = feed->frame_duration;
+    GST_BUFFER_OFFSET(buffer) = au.frame_number;
+    if (!au.keyframe) {
+        GST_BUFFER_FLAG_SET(buffer, GST_BUFFER_FLAG_DELTA_UNIT);
+    }
+
+    gst_app_src_push_buffer(appsrc, buffer);
+}
+
+// Emitted before the media changes pipeline state. Only teardown (READY or
+// NULL) releases the pacing wait: prepare targets PAUSED before it plays a
+// live pipeline with no further signal, and a paused media still needs
+// need_data to push, so PAUSED must not stop the feed.
+void on_synthetic_target_state(GstRTSPMedia* /*media*/, gint state, gpointer user_data) {
+    auto* feed = static_cast<SyntheticFeed*>(user_data);
+    std::lock_guard lock(feed->wait_lock);
+
+    feed->stopping = state <= GST_STATE_READY;
+    if (feed->stopping && feed->pending_wait) {
+        gst_clock_id_unschedule(feed->pending_wait);
+    }
+}
+
+void destroy_synthetic_feed(gpointer user_data) {
+    delete static_cast<SyntheticFeed*>(user_data);
+}
+
+} // namespace
+
+MediaPipeline::MediaPipeline(const SourceConfig& source) 
+    : source_(source), factory_(nullptr) {}
 
 MediaPipeline::~MediaPipeline() {
     if (factory_) {
@@ -15,8 +115,20 @@ MediaPipeline::~MediaPipeline() {
 }
 
 std::expected<void, std::string> MediaPipeline::create_factory() {
-    if (!std::filesystem::exists(media_file_)) {
-        return std::unexpected(std::format("Media file not found: {}", media_file_));
+    if (source_.type == SourceType::File && !std::filesystem::exists(source_.media_file)) {
+        return std::unexpected(std::format("Media file not found: {}", source_.media_file));
+    }
+    if (source_.type == SourceType::Srt && !source_.srt.uri.starts_with("srt://")) {
+        return std::unexpected(std::format("Invalid SRT listen URI: {}", source_.srt.uri));
+    }
+
+    // The SRT listener runs from startup, not per RTSP session, so a camera
+    // can connect (and stay connected) whether or not anyone is watching
+    if (source_.type == SourceType::Srt) {
+        ingest_ = std::make_unique<SrtIngest>(source_.srt);
+        if (auto result = ingest_->start(); !result) {
+            return result;
+        }
     }
 
     factory_ = gst_rtsp_media_factory_new();
@@ -36,6 +148,15 @@ std::expected<void, std::string> MediaPipeline::create_factory() {
 }
 
 std::string MediaPipeline::build_pipeline_string() const {
+    switch (source_.type) {
+        case SourceType::Synthetic: return build_synthetic_pipeline_string();
+        case SourceType::Srt:       return build_srt_pipeline_string();
+        case SourceType::File:
+        default:                    return build_file_pipeline_string();
+    }
+}
+
+std::string MediaPipeline::build_file_pipeline_string() const {
     return std::format(
         // Cross-platform file-based pipeline: works on both macOS and Ubuntu Docker
         "( "
@@ -63,13 +184,102 @@ std::string MediaPipeline::build_pipeline_string() const {
             // name=pay0: Named element required by RTSP media factory
             "rtph264pay name=pay0 pt=96 "
         ")",
-        media_file_
+        source_.media_file
+    );
+}
+
+std::string MediaPipeline::build_synthetic_pipeline_string() const {
+    const auto& synthetic = source_.synthetic;
+    const auto size = frame_size(synthetic.resolution);
+
+    return std::format(
+        // Encoder-free test pattern for capacity testing, no media file needed
+        "( "
+            // Access units are pushed from on_synthetic_need_data, paced to the clock
+            // min-latency: a frame is released exactly at its running time
+            "appsrc name=synthsrc is-live=true format=time min-latency={} "
+            "caps=\"video/x-h264,stream-format=byte-stream,alignment=au,"
+            "profile=constrained-baseline,width={},height={},framerate={}/1\" "
+        "! "
+            // Parse H.264 stream structure, same as the file pipeline
+            "h264parse "
+        "! "
+            // Package H.264 into RTP packets for RTSP streaming
+            "rtph264pay name=pay0 pt=96 "
+        ")",
+        static_cast<GstClockTime>(GST_SECOND) / synthetic.fps,
+        size.width, size.height, synthetic.fps
+    );
+}
+
+std::string MediaPipeline::build_srt_pipeline_string() const {
+    return std::format(
+        // Live SRT ingest re-served as RTSP: no decode, H.264 passes straight through
+        "( "
+            // Access units are pushed by SrtIngest, restamped to this pipeline's clock
+            // min-latency: playout delay that absorbs arrival jitter between the two
+            // max-time/max-bytes: queue bound, SrtIngest flushes and resyncs on reaching it
+            "appsrc name=ingestsrc is-live=true format=time min-latency={} "
+            "max-time={} max-bytes={} "
+        "! "
+            // Parse H.264 stream structure, same as the file pipeline
+            "h264parse "
+        "! "
+            // Package H.264 into RTP packets for RTSP streaming
+            "rtph264pay name=pay0 pt=96 "
+        ")",
+        static_cast<GstClockTime>(source_.srt.buffer_ms) * GST_MSECOND,
+        2 * static_cast<GstClockTime>(source_.srt.buffer_ms) * GST_MSECOND,
+        SrtIngest::MAX_QUEUED_BYTES
     );
 }
 
+void MediaPipeline::attach_synthetic_feed(GstRTSPMedia* media) const {
+    GstElement* element = gst_rtsp_media_get_element(media);
+    GstElement* appsrc = gst_bin_get_by_name_recurse_up(GST_BIN(element), "synthsrc");
+    gst_object_unref(element);
+
+    if (!appsrc) {
+        Logger::error("Synthetic source element not found in media pipeline");
+        return;
+    }
+
+    GstAppSrcCallbacks callbacks{};
+    callbacks.need_data = on_synthetic_need_data;
+
+    auto* feed = new SyntheticFeed(source_.synthetic);
+    gst_app_src_set_callbacks(GST_APP_SRC(appsrc), &callbacks, feed, destroy_synthetic_feed);
+
+    // The media owns the pipeline and with it the appsrc holding feed,
+    // so the handler cannot outlive feed
+    g_signal_connect(media, "target-state", G_CALLBACK(on_synthetic_target_state), feed);
+    gst_object_unref(appsrc);
+}
+
+void MediaPipeline::attach_srt_output(GstRTSPMedia* media) const {
+    GstElement* element = gst_rtsp_media_get_element(media);
+    GstElement* appsrc = gst_bin_get_by_name_recurse_up(GST_BIN(element), "ingestsrc");
+    gst_object_unref(element);
+
+    if (!appsrc) {
+        Logger::error("SRT ingest element not found in media pipeline");
+        return;
+    }
+
+    ingest_->add_output(GST_APP_SRC(appsrc), G_OBJECT(media));
+    gst_object_unref(appsrc);
+}
+
 void MediaPipeline::on_media_configure(GstRTSPMediaFactory* /*factory*/, 
-                                       GstRTSPMedia* media, gpointer /*user_data*/) {
+                                       GstRTSPMedia* media, gpointer user_data) {
     Logger::debug("Media configured for streaming");
+
+    auto* pipeline = static_cast<MediaPipeline*>(user_data);
+    if (pipeline->source_.type == SourceType::Synthetic) {
+        pipeline->attach_synthetic_feed(media);
+    } else if (pipeline->source_.type == SourceType::Srt) {
+        pipeline->attach_srt_output(media);
+    }
     
     // Configure media for multiple client support (vlc and pipeline 2 at the same time)
     gst_rtsp_media_set_reusable(media, TRUE);
@@ -5,22 +5,39 @@
 #include <memory>
 #include <gst/gst.h>
 #include <gst/rtsp-server/rtsp-server.h>
+#include "synthetic_source.hpp"
+#include "srt_ingest.hpp"
 
 namespace paladium {
 
+enum class SourceType { File, Synthetic, Srt };
+
+struct SourceConfig {
+    SourceType type = SourceType::File;
+    std::string media_file;
+    SyntheticConfig synthetic;
+    SrtIngestConfig srt;
+};
+
 class MediaPipeline {
 public:
-    explicit MediaPipeline(const std::string& media_file);
+    explicit MediaPipeline(const SourceConfig& source);
     ~MediaPipeline();
 
     std::expected<void, std::string> create_factory();
     GstRTSPMediaFactory* get_factory() const { return factory_; }
 
 private:
-    std::string media_file_;
+    SourceConfig source_;
     GstRTSPMediaFactory* factory_;
+    std::unique_ptr<SrtIngest> ingest_;
 
     std::string build_pipeline_string() const;
+    std::string build_file_pipeline_string() const;
+    std::string build_synthetic_pipeline_string() const;
+    std::string build_srt_pipeline_string() const;
+    void attach_synthetic_feed(GstRTSPMedia* media) const;
+    void attach_srt_output(GstRTSPMedia* media) const;
     static void on_media_configure(GstRTSPMediaFactory* factory, 
                                    GstRTSPMedia* media, gpointer user_data);
 };
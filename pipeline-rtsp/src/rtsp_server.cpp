@@ -4,8 +4,8 @@
 
 namespace paladium {
 
-RTSPServer::RTSPServer(const std::string& media_file, uint16_t rtsp_port) 
-    : media_file_(media_file), rtsp_port_(rtsp_port) {
+RTSPServer::RTSPServer(const SourceConfig& source, uint16_t rtsp_port) 
+    : source_(source), rtsp_port_(rtsp_port) {
     gst_init(nullptr, nullptr);
 }
 
@@ -41,12 +41,22 @@ std::expected<void, std::string> RTSPServer::initialize() {
 std::expected<void, std::string> RTSPServer::setup_mount_points() {
     mounts_.reset(gst_rtsp_server_get_mount_points(server_.get()));
     
-    pipeline_ = std::make_unique<MediaPipeline>(media_file_);
-    if (auto result = pipeline_->create_factory(); !result) {
-        return std::unexpected(std::format("Pipeline creation failed: {}", result.error()));
+    // Synthetic sources can be fanned out to many mounts for capacity testing,
+    // each with its own pipeline and frame counter
+    const uint32_t mount_count = source_.type == SourceType::Synthetic ? source_.synthetic.streams : 1;
+
+    for (uint32_t i = 1; i <= mount_count; ++i) {
+        auto pipeline = std::make_unique<MediaPipeline>(source_);
+        if (auto result = pipeline->create_factory(); !result) {
+            return std::unexpected(std::format("Pipeline creation failed: {}", result.error()));
+        }
+
+        // The mount table holds its own reference to the factory
+        g_object_ref(pipeline->get_factory());
+        gst_rtsp_mount_points_add_factory(mounts_.get(), std::format("/cam{}", i).c_str(),
+                                          pipeline->get_factory());
+        pipelines_.push_back(std::move(pipeline));
     }
-
-    gst_rtsp_mount_points_add_factory(mounts_.get(), "/cam1", pipeline_->get_factory());
     
     return {};
 }
@@ -58,6 +68,9 @@ int RTSPServer::run() {
     }
 
     Logger::info("RTSP server ready at rtsp://localhost:{}/cam1", rtsp_port_);
+    if (pipelines_.size() > 1) {
+        Logger::info("Serving {} mounts: /cam1 .. /cam{}", pipelines_.size(), pipelines_.size());
+    }
     g_main_loop_run(loop_.get());
     
     return 0;
@@ -3,6 +3,7 @@
 #include <expected>
 #include <string>
 #include <memory>
+#include <vector>
 #include <cstdint>
 #include <gst/gst.h>
 #include <gst/rtsp-server/rtsp-server.h>
@@ -12,7 +13,7 @@ namespace paladium {
 
 class RTSPServer {
 public:
-    RTSPServer(const std::string& media_file, uint16_t rtsp_port);
+    RTSPServer(const SourceConfig& source, uint16_t rtsp_port);
     ~RTSPServer();
 
     std::expected<void, std::string> initialize();
@@ -26,12 +27,12 @@ private:
         void operator()(GMainLoop* loop) { if (loop) g_main_loop_unref(loop); }
     };
 
-    std::string media_file_;
+    SourceConfig source_;
     uint16_t rtsp_port_;
     std::unique_ptr<GstRTSPServer, GstDeleter> server_;
     std::unique_ptr<GstRTSPMountPoints, GstDeleter> mounts_;
     std::unique_ptr<GMainLoop, GstDeleter> loop_;
-    std::unique_ptr<MediaPipeline> pipeline_;
+    std::vector<std::unique_ptr<MediaPipeline>> pipelines_;
 
     std::expected<void, std::string> setup_mount_points();
     static gboolean on_client_connected(GstRTSPClient* client, gpointer user_data);
@@ -0,0 +1,265 @@
+#include "srt_ingest.hpp"
+#include "../../utils/logger.hpp"
+#include <algorithm>
+#include <format>
+
+namespace paladium {
+
+SrtIngest::SrtIngest(const SrtIngestConfig& config)
+    : config_(config) {}
+
+SrtIngest::~SrtIngest() {
+    if (restart_source_) {
+        g_source_remove(restart_source_);
+    }
+    if (bus_watch_) {
+        g_source_remove(bus_watch_);
+    }
+    pipeline_.reset();
+
+    std::lock_guard lock(outputs_lock_);
+    for (auto& output : outputs_) {
+        g_object_weak_unref(output->owner, on_owner_finalized, output.get());
+        gst_object_unref(output->appsrc);
+    }
+}
+
+std::expected<void, std::string> SrtIngest::start() {
+    GError* error = nullptr;
+    auto pipeline_str = build_pipeline_string();
+
+    pipeline_.reset(gst_parse_launch(pipeline_str.c_str(), &error));
+    if (!pipeline_) {
+        std::string error_msg = error ? error->message : "Unknown error";
+        if (error) g_error_free(error);
+        return std::unexpected(std::format("Failed to create SRT ingest pipeline: {}", error_msg));
+    }
+    if (error) {
+        Logger::warn("SRT ingest pipeline created with warnings: {}", error->message);
+        g_error_free(error);
+    }
+
+    GstElement* appsink = gst_bin_get_by_name(GST_BIN(pipeline_.get()), "ingestsink");
+    if (!appsink) {
+        return std::unexpected("SRT ingest sink element not found");
+    }
+    GstAppSinkCallbacks callbacks{};
+    callbacks.new_sample = on_new_sample;
+    gst_app_sink_set_callbacks(GST_APP_SINK(appsink), &callbacks, this, nullptr);
+    gst_object_unref(appsink);
+
+    GstBus* bus = gst_element_get_bus(pipeline_.get());
+    bus_watch_ = gst_bus_add_watch(bus, on_bus_message, this);
+    gst_object_unref(bus);
+
+    if (gst_element_set_state(pipeline_.get(), GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
+        return std::unexpected(std::format("Failed to start SRT listener on {}", config_.uri));
+    }
+
+    Logger::info("SRT ingest pipeline: {}", pipeline_str);
+    return {};
+}
+
+std::string SrtIngest::build_pipeline_string() const {
+    return std::format(
+        // Listen for an SRT caller (camera, encoder) publishing MPEG-TS;
+        // latency is SRT's receive buffer, the actual network jitter buffer
+        "srtserversrc uri={} latency={} "
+        "! "
+        // Demultiplex MPEG-TS; pad names depend on the PID, so the delayed
+        // link is filtered to H.264 and audio or data pads stay unlinked
+        "tsdemux name=d "
+        "d. ! video/x-h264 "
+        "! "
+        // Parse H.264 without decoding, send SPS/PPS with every keyframe so
+        // RTSP clients joining mid-stream can decode
+        "h264parse config-interval=-1 "
+        "! "
+        // Ensure H.264 is in byte-stream format and AU-aligned
+        "video/x-h264,stream-format=byte-stream,alignment=au "
+        "! "
+        // Hand access units to forward() as they arrive, RTSP side does the pacing
+        "appsink name=ingestsink sync=false",
+        config_.uri, config_.latency_ms
+    );
+}
+
+void SrtIngest::add_output(GstAppSrc* appsrc, GObject* owner) {
+    auto output = std::make_unique<Output>(Output{ this, GST_APP_SRC(gst_object_ref(appsrc)), owner });
+    g_object_weak_ref(owner, on_owner_finalized, output.get());
+
+    std::lock_guard lock(outputs_lock_);
+    outputs_.push_back(std::move(output));
+}
+
+void SrtIngest::remove_output(Output* output) {
+    std::lock_guard lock(outputs_lock_);
+    auto it = std::find_if(outputs_.begin(), outputs_.end(),
+                           [output](const auto& entry) { return entry.get() == output; });
+    if (it != outputs_.end()) {
+        gst_object_unref((*it)->appsrc);
+        outputs_.erase(it);
+    }
+}
+
+void SrtIngest::forward(GstSample* sample) {
+    GstBuffer* buffer = gst_sample_get_buffer(sample);
+    GstCaps* caps = gst_sample_get_caps(sample);
+    if (!buffer) {
+        return;
+    }
+
+    const GstClockTime ts = GST_BUFFER_DTS_IS_VALID(buffer) ? GST_BUFFER_DTS(buffer)
+                                                             : GST_BUFFER_PTS(buffer);
+    if (!GST_CLOCK_TIME_IS_VALID(ts)) {
+        return;
+    }
+
+    const bool keyframe = !GST_BUFFER_FLAG_IS_SET(buffer, GST_BUFFER_FLAG_DELTA_UNIT);
+    const GstClockTimeDiff window = static_cast<GstClockTimeDiff>(config_.buffer_ms) * GST_MSECOND;
+
+    std::lock_guard lock(outputs_lock_);
+    for (auto& output : outputs_) {
+        GstElement* element = GST_ELEMENT(output->appsrc);
+        GstClock* clock = gst_element_get_clock(element);
+        if (!clock) {
+            // Media not playing yet (or any more): start it on a keyframe later
+            output->need_keyframe = true;
+            continue;
+        }
+        const GstClockTime base_time = gst_element_get_base_time(element);
+        const GstClockTimeDiff now = GST_CLOCK_DIFF(base_time, gst_clock_get_time(clock));
+        gst_object_unref(clock);
+
+        if (base_time != output->base_time) {
+            output->base_time = base_time;
+            output->need_keyframe = true;
+        }
+
+        // Dropping a single access unit would corrupt every client's decode
+        // until the next IDR. So when the feed drifts outside the playout
+        // window (late or bursting ahead) or the appsrc queue reaches its
+        // bound, flush what is queued, drop up to the next keyframe and
+        // re-anchor there. The queue never grows past max-time/max-bytes.
+        const bool full = gst_app_src_get_current_level_time(output->appsrc)
+                              >= gst_app_src_get_max_time(output->appsrc)
+                          || gst_app_src_get_current_level_bytes(output->appsrc)
+                              >= gst_app_src_get_max_bytes(output->appsrc);
+        const GstClockTimeDiff out_ts = static_cast<GstClockTimeDiff>(ts) + output->offset;
+        if (full || (!output->need_keyframe && (out_ts < now - window || out_ts > now + window))) {
+            if (!output->need_keyframe) {
+                Logger::warn("SRT ingest outside {} ms buffer, dropping until next keyframe",
+                             config_.buffer_ms);
+            }
+            flush_queued(output->appsrc);
+            output->need_keyframe = true;
+        }
+        if (output->need_keyframe) {
+            if (!keyframe) {
+                continue;
+            }
+            output->offset = now - static_cast<GstClockTimeDiff>(ts);
+            output->need_keyframe = false;
+        }
+
+        GstBuffer* out = gst_buffer_copy(buffer);
+        if (GST_BUFFER_PTS_IS_VALID(out)) {
+            GST_BUFFER_PTS(out) = std::max<GstClockTimeDiff>(0, GST_BUFFER_PTS(out) + output->offset);
+        }
+        if (GST_BUFFER_DTS_IS_VALID(out)) {
+            GST_BUFFER_DTS(out) = std::max<GstClockTimeDiff>(0, GST_BUFFER_DTS(out) + output->offset);
+        }
+
+        gst_app_src_set_caps(output->appsrc, caps);
+        gst_app_src_push_buffer(output->appsrc, out);
+    }
+}
+
+void SrtIngest::flush_queued(GstAppSrc* appsrc) {
+    // appsrc empties its internal queue on flush-stop; running time is kept
+    GstElement* element = GST_ELEMENT(appsrc);
+    gst_element_send_event(element, gst_event_new_flush_start());
+    gst_element_send_event(element, gst_event_new_flush_stop(FALSE));
+}
+
+void SrtIngest::schedule_restart() {
+    if (restart_source_) {
+        return;
+    }
+    Logger::warn("Restarting SRT listener in 1 second...");
+    restart_source_ = g_timeout_add_seconds(1, on_restart, this);
+}
+
+GstFlowReturn SrtIngest::on_new_sample(GstAppSink* appsink, gpointer user_data) {
+    auto* ingest = static_cast<SrtIngest*>(user_data);
+    GstSample* sample = gst_app_sink_pull_sample(appsink);
+    if (!sample) {
+        return GST_FLOW_EOS;
+    }
+
+    ingest->forward(sample);
+    gst_sample_unref(sample);
+    return GST_FLOW_OK;
+}
+
+gboolean SrtIngest::on_bus_message(GstBus* /*bus*/, GstMessage* message, gpointer user_data) {
+    auto* ingest = static_cast<SrtIngest*>(user_data);
+    GError* error = nullptr;
+    gchar* debug = nullptr;
+
+    switch (GST_MESSAGE_TYPE(message)) {
+        case GST_MESSAGE_ERROR: {
+            gst_message_parse_error(message, &error, &debug);
+            Logger::error("SRT ingest error: {}", error ? error->message : "Unknown error");
+            if (debug) Logger::debug("Debug info: {}", debug);
+            ingest->schedule_restart();
+            break;
+        }
+        case GST_MESSAGE_EOS: {
+            // The caller disconnected: go back to listening for the next one
+            Logger::warn("SRT caller disconnected");
+            ingest->schedule_restart();
+            break;
+        }
+        case GST_MESSAGE_WARNING: {
+            gst_message_parse_warning(message, &error, &debug);
+            Logger::warn("SRT ingest warning: {}", error ? error->message : "Unknown warning");
+            break;
+        }
+        default:
+            break;
+    }
+
+    if (error) g_error_free(error);
+    if (debug) g_free(debug);
+
+    return TRUE;
+}
+
+gboolean SrtIngest::on_restart(gpointer user_data) {
+    auto* ingest = static_cast<SrtIngest*>(user_data);
+    ingest->restart_source_ = 0;
+
+    {
+        std::lock_guard lock(ingest->outputs_lock_);
+        for (auto& output : ingest->outputs_) {
+            output->need_keyframe = true;
+        }
+    }
+
+    gst_element_set_state(ingest->pipeline_.get(), GST_STATE_NULL);
+    if (gst_element_set_state(ingest->pipeline_.get(), GST_STATE_PLAYING) == GST_STATE_CHANGE_FAILURE) {
+        Logger::error("Failed to restart SRT listener on {}", ingest->config_.uri);
+        ingest->schedule_restart();
+    } else {
+        Logger::info("SRT listener waiting on {}", ingest->config_.uri);
+    }
+    return G_SOURCE_REMOVE;
+}
+
+void SrtIngest::on_owner_finalized(gpointer user_data, GObject* /*owner*/) {
+    auto* output = static_cast<Output*>(user_data);
+    output->ingest->remove_output(output);
+}
+
+} // namespace paladium
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <expected>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <gst/gst.h>
+#include <gst/app/gstappsink.h>
+#include <gst/app/gstappsrc.h>
+
+namespace paladium {
+
+struct SrtIngestConfig {
+    std::string uri = "srt://:9000";   // Listener address the SRT caller publishes to
+    uint32_t latency_ms = 200;          // SRT receive latency: absorbs network jitter and retransmits
+    uint32_t buffer_ms = 500;           // RTSP playout delay; frames further off are dropped up to the next keyframe
+};
+
+// Always-on SRT listener: accepts MPEG-TS from an SRT caller independently of
+// RTSP sessions, demuxes the H.264 without decoding and fans it out to the
+// appsrc of every registered RTSP media pipeline.
+class SrtIngest {
+public:
+    // Hard cap on each RTSP media's appsrc queue, next to max-time = 2 x buffer_ms
+    static constexpr guint64 MAX_QUEUED_BYTES = 16 * 1024 * 1024;
+
+    explicit SrtIngest(const SrtIngestConfig& config);
+    ~SrtIngest();
+
+    std::expected<void, std::string> start();
+
+    // Feeds appsrc until owner (the RTSP media) is finalized
+    void add_output(GstAppSrc* appsrc, GObject* owner);
+
+private:
+    struct GstDeleter {
+        void operator()(GstElement* element) {
+            if (element) {
+                gst_element_set_state(element, GST_STATE_NULL);
+                gst_object_unref(element);
+            }
+        }
+    };
+
+    struct Output {
+        SrtIngest* ingest;
+        GstAppSrc* appsrc;                          // Strong reference
+        GObject* owner;                             // Weak reference
+        GstClockTime base_time = GST_CLOCK_TIME_NONE;
+        GstClockTimeDiff offset = 0;                // Ingest timestamp -> media running time
+        bool need_keyframe = true;
+    };
+
+    SrtIngestConfig config_;
+    std::unique_ptr<GstElement, GstDeleter> pipeline_;
+    guint bus_watch_ = 0;
+    guint restart_source_ = 0;
+
+    std::mutex outputs_lock_;
+    std::vector<std::unique_ptr<Output>> outputs_;
+
+    std::string build_pipeline_string() const;
+    void forward(GstSample* sample);
+    static void flush_queued(GstAppSrc* appsrc);
+    void schedule_restart();
+    void remove_output(Output* output);
+
+    static GstFlowReturn on_new_sample(GstAppSink* appsink, gpointer user_data);
+    static gboolean on_bus_message(GstBus* bus, GstMessage* message, gpointer user_data);
+    static gboolean on_restart(gpointer user_data);
+    static void on_owner_finalized(gpointer user_data, GObject* owner);
+};
+
+} // namespace paladium
@@ -0,0 +1,327 @@
+#include "synthetic_source.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <format>
+
+namespace paladium {
+
+namespace {
+
+// Built-in resolution table
+struct ResolutionInfo {
+    ResolutionClass resolution;
+    std::string_view name;
+    uint32_t width;
+    uint32_t height;
+};
+
+constexpr std::array<ResolutionInfo, 3> RESOLUTIONS = {{
+    { ResolutionClass::SD360,   "360p",  640,  360 },
+    { ResolutionClass::HD720,   "720p",  1280, 720 },
+    { ResolutionClass::FHD1080, "1080p", 1920, 1080 },
+}};
+
+// H.264 Table A-1 limits (MaxBR in kbit/s for the Baseline profile)
+struct LevelLimits {
+    uint8_t level_idc;
+    uint32_t max_mbps;
+    uint32_t max_fs;
+    uint32_t max_br_kbps;
+};
+
+constexpr std::array<LevelLimits, 16> LEVELS = {{
+    { 10, 1485,    99,    64 },
+    { 11, 3000,    396,   192 },
+    { 12, 6000,    396,   384 },
+    { 13, 11880,   396,   768 },
+    { 20, 11880,   396,   2000 },
+    { 21, 19800,   792,   4000 },
+    { 22, 20250,   1620,  4000 },
+    { 30, 40500,   1620,  10000 },
+    { 31, 108000,  3600,  14000 },
+    { 32, 216000,  5120,  20000 },
+    { 40, 245760,  8192,  20000 },
+    { 41, 245760,  8192,  50000 },
+    { 42, 522240,  8704,  50000 },
+    { 50, 589824,  22080, 135000 },
+    { 51, 983040,  36864, 240000 },
+    { 52, 2073600, 36864, 240000 },
+}};
+
+const ResolutionInfo& resolution_info(ResolutionClass resolution) {
+    for (const auto& info : RESOLUTIONS) {
+        if (info.resolution == resolution) return info;
+    }
+    return RESOLUTIONS[1];
+}
+
+// NAL unit headers (forbidden_zero_bit | nal_ref_idc | nal_unit_type)
+constexpr uint8_t NAL_SLICE_P = 0x41;   // ref_idc 2, non-IDR slice
+constexpr uint8_t NAL_SLICE_IDR = 0x65; // ref_idc 3, IDR slice
+constexpr uint8_t NAL_SEI = 0x06;
+constexpr uint8_t NAL_SPS = 0x67;
+constexpr uint8_t NAL_PPS = 0x68;
+constexpr uint8_t NAL_FILLER = 0x0c;
+
+constexpr uint32_t LOG2_MAX_FRAME_NUM = 16;
+
+// One I_16x16 macroblock with DC prediction and no residual, CAVLC:
+// mb_type ue(3) "00100", intra_chroma_pred_mode ue(0) "1",
+// mb_qp_delta se(0) "1", Intra16x16DCLevel coeff_token (nC=0, 0 coeffs) "1"
+constexpr uint8_t FLAT_I16X16_MB = 0x27;
+
+constexpr uint8_t SEI_USER_DATA_UNREGISTERED = 5;
+
+class BitWriter {
+public:
+    void bits(uint64_t value, int count) {
+        for (int i = count - 1; i >= 0; --i) {
+            bit((value >> i) & 1);
+        }
+    }
+
+    void bit(bool value) {
+        if (bit_pos_ == 0) bytes_.push_back(0);
+        if (value) bytes_.back() |= static_cast<uint8_t>(0x80 >> bit_pos_);
+        bit_pos_ = (bit_pos_ + 1) % 8;
+    }
+
+    // Exp-Golomb codes (H.264 9.1)
+    void ue(uint32_t value) {
+        uint64_t code = static_cast<uint64_t>(value) + 1;
+        int length = std::bit_width(code);
+        bits(0, length - 1);
+        bits(code, length);
+    }
+
+    void se(int32_t value) {
+        ue(value > 0 ? 2 * static_cast<uint32_t>(value) - 1
+                     : 2 * static_cast<uint32_t>(-value));
+    }
+
+    void rbsp_trailing_bits() {
+        bit(1);
+        while (bit_pos_ != 0) bit(0);
+    }
+
+    const std::vector<uint8_t>& bytes() const { return bytes_; }
+
+private:
+    std::vector<uint8_t> bytes_;
+    int bit_pos_ = 0;
+};
+
+// Writes start code + header + RBSP with emulation prevention bytes
+void append_nal(std::vector<uint8_t>& out, uint8_t header, const std::vector<uint8_t>& rbsp) {
+    out.insert(out.end(), { 0x00, 0x00, 0x00, 0x01, header });
+
+    int zeros = 0;
+    for (uint8_t byte : rbsp) {
+        if (zeros >= 2 && byte <= 0x03) {
+            out.push_back(0x03);
+            zeros = 0;
+        }
+        out.push_back(byte);
+        zeros = byte == 0 ? zeros + 1 : 0;
+    }
+}
+
+void append_u64(std::vector<uint8_t>& out, uint64_t value) {
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        out.push_back(static_cast<uint8_t>(value >> shift));
+    }
+}
+
+} // namespace
+
+std::expected<ResolutionClass, std::string> parse_resolution_class(std::string_view name) {
+    for (const auto& info : RESOLUTIONS) {
+        if (info.name == name) return info.resolution;
+    }
+    return std::unexpected(std::format("Unknown resolution class '{}' (expected 360p, 720p or 1080p)", name));
+}
+
+std::string_view resolution_class_name(ResolutionClass resolution) {
+    return resolution_info(resolution).name;
+}
+
+FrameSize frame_size(ResolutionClass resolution) {
+    const auto& info = resolution_info(resolution);
+    return { info.width, info.height };
+}
+
+std::expected<uint8_t, std::string> h264_level(const SyntheticConfig& config) {
+    const auto& info = resolution_info(config.resolution);
+    const uint64_t mb_count = static_cast<uint64_t>((info.width + 15) / 16) * ((info.height + 15) / 16);
+    const uint64_t mbps = mb_count * config.fps;
+
+    // An IDR costs one byte per macroblock and may exceed the per-frame
+    // budget at low bitrates, so bound the peak by an all-IDR stream too
+    const uint64_t idr_kbps = (mb_count * 8 * config.fps + 999) / 1000;
+    const uint64_t peak_kbps = std::max<uint64_t>(config.bitrate_kbps, idr_kbps);
+
+    for (const auto& level : LEVELS) {
+        if (mb_count <= level.max_fs && mbps <= level.max_mbps && peak_kbps <= level.max_br_kbps) {
+            return level.level_idc;
+        }
+    }
+    return std::unexpected(std::format(
+        "No H.264 level fits {} @ {} fps, {} kbps (limit: level 5.2, {} MB/s, {} kbps)",
+        info.name, config.fps, config.bitrate_kbps, LEVELS.back().max_mbps, LEVELS.back().max_br_kbps));
+}
+
+SyntheticH264Source::SyntheticH264Source(const SyntheticConfig& config)
+    : config_(config) {
+    const auto& info = resolution_info(config_.resolution);
+    const uint32_t mb_width = (info.width + 15) / 16;
+    const uint32_t mb_height = (info.height + 15) / 16;
+    mb_count_ = mb_width * mb_height;
+    target_au_bytes_ = static_cast<size_t>(config_.bitrate_kbps) * 1000 / 8 / config_.fps;
+
+    // Sequence parameter set: constrained baseline, POC type 2 (output order
+    // equals decode order), a single reference frame
+    BitWriter sps;
+    sps.bits(66, 8);                        // profile_idc: baseline
+    sps.bits(0xc0, 8);                      // constraint_set0/1: constrained baseline
+    sps.bits(h264_level(config_).value_or(LEVELS.back().level_idc), 8);
+    sps.ue(0);                              // seq_parameter_set_id
+    sps.ue(LOG2_MAX_FRAME_NUM - 4);
+    sps.ue(2);                              // pic_order_cnt_type
+    sps.ue(1);                              // max_num_ref_frames
+    sps.bit(0);                             // gaps_in_frame_num_value_allowed_flag
+    sps.ue(mb_width - 1);
+    sps.ue(mb_height - 1);
+    sps.bit(1);                             // frame_mbs_only_flag
+    sps.bit(1);                             // direct_8x8_inference_flag
+    const uint32_t crop_bottom = (mb_height * 16 - info.height) / 2;
+    const uint32_t crop_right = (mb_width * 16 - info.width) / 2;
+    sps.bit(crop_bottom || crop_right);     // frame_cropping_flag
+    if (crop_bottom || crop_right) {
+        sps.ue(0);
+        sps.ue(crop_right);
+        sps.ue(0);
+        sps.ue(crop_bottom);
+    }
+    sps.bit(1);                             // vui_parameters_present_flag
+    sps.bit(0);                             // aspect_ratio_info_present_flag
+    sps.bit(0);                             // overscan_info_present_flag
+    sps.bit(0);                             // video_signal_type_present_flag
+    sps.bit(0);                             // chroma_loc_info_present_flag
+    sps.bit(1);                             // timing_info_present_flag
+    sps.bits(1, 32);                        // num_units_in_tick
+    sps.bits(2 * config_.fps, 32);          // time_scale (two ticks per frame)
+    sps.bit(1);                             // fixed_frame_rate_flag
+    sps.bit(0);                             // nal_hrd_parameters_present_flag
+    sps.bit(0);                             // vcl_hrd_parameters_present_flag
+    sps.bit(0);                             // pic_struct_present_flag
+    sps.bit(0);                             // bitstream_restriction_flag
+    sps.rbsp_trailing_bits();
+
+    BitWriter pps;
+    pps.ue(0);                              // pic_parameter_set_id
+    pps.ue(0);                              // seq_parameter_set_id
+    pps.bit(0);                             // entropy_coding_mode_flag: CAVLC
+    pps.bit(0);                             // bottom_field_pic_order_in_frame_present_flag
+    pps.ue(0);                              // num_slice_groups_minus1
+    pps.ue(0);                              // num_ref_idx_l0_default_active_minus1
+    pps.ue(0);                              // num_ref_idx_l1_default_active_minus1
+    pps.bit(0);                             // weighted_pred_flag
+    pps.bits(0, 2);                         // weighted_bipred_idc
+    pps.se(0);                              // pic_init_qp_minus26
+    pps.se(0);                              // pic_init_qs_minus26
+    pps.se(0);                              // chroma_qp_index_offset
+    pps.bit(0);                             // deblocking_filter_control_present_flag
+    pps.bit(0);                             // constrained_intra_pred_flag
+    pps.bit(0);                             // redundant_pic_cnt_present_flag
+    pps.rbsp_trailing_bits();
+
+    append_nal(parameter_sets_, NAL_SPS, sps.bytes());
+    append_nal(parameter_sets_, NAL_PPS, pps.bytes());
+
+    for (uint32_t idr_pic_id = 0; idr_pic_id < 2; ++idr_pic_id) {
+        BitWriter slice;
+        slice.ue(0);                        // first_mb_in_slice
+        slice.ue(7);                        // slice_type: I (all slices)
+        slice.ue(0);                        // pic_parameter_set_id
+        slice.bits(0, LOG2_MAX_FRAME_NUM);  // frame_num
+        slice.ue(idr_pic_id);
+        slice.bit(0);                       // no_output_of_prior_pics_flag
+        slice.bit(0);                       // long_term_reference_flag
+        slice.se(0);                        // slice_qp_delta
+        for (uint32_t mb = 0; mb < mb_count_; ++mb) {
+            slice.bits(FLAT_I16X16_MB, 8);
+        }
+        slice.rbsp_trailing_bits();
+        append_nal(idr_slices_[idr_pic_id], NAL_SLICE_IDR, slice.bytes());
+    }
+}
+
+AccessUnit SyntheticH264Source::next_access_unit(uint64_t wallclock_us) {
+    const bool keyframe = gop_position_ == 0;
+
+    AccessUnit au{ {}, frame_number_, keyframe };
+    au.data.reserve(std::max(target_au_bytes_, keyframe ? parameter_sets_.size() + idr_slices_[0].size() + 64 : size_t{64}));
+
+    if (keyframe) {
+        au.data.insert(au.data.end(), parameter_sets_.begin(), parameter_sets_.end());
+    }
+    if (config_.embed_sei) {
+        append_sei(au.data, wallclock_us);
+    }
+    if (keyframe) {
+        const auto& slice = idr_slices_[idr_count_++ % 2];
+        au.data.insert(au.data.end(), slice.begin(), slice.end());
+    } else {
+        auto slice = build_p_slice(gop_position_ % (1u << LOG2_MAX_FRAME_NUM));
+        au.data.insert(au.data.end(), slice.begin(), slice.end());
+    }
+    append_filler(au.data);
+
+    ++frame_number_;
+    gop_position_ = (gop_position_ + 1) % config_.gop;
+    return au;
+}
+
+std::vector<uint8_t> SyntheticH264Source::build_p_slice(uint32_t frame_num) const {
+    BitWriter slice;
+    slice.ue(0);                            // first_mb_in_slice
+    slice.ue(5);                            // slice_type: P (all slices)
+    slice.ue(0);                            // pic_parameter_set_id
+    slice.bits(frame_num, LOG2_MAX_FRAME_NUM);
+    slice.bit(0);                           // num_ref_idx_active_override_flag
+    slice.bit(0);                           // ref_pic_list_modification_flag_l0
+    slice.bit(0);                           // adaptive_ref_pic_marking_mode_flag
+    slice.se(0);                            // slice_qp_delta
+    slice.ue(mb_count_);                    // mb_skip_run: every macroblock
+    slice.rbsp_trailing_bits();
+
+    std::vector<uint8_t> nal;
+    append_nal(nal, NAL_SLICE_P, slice.bytes());
+    return nal;
+}
+
+void SyntheticH264Source::append_sei(std::vector<uint8_t>& au, uint64_t wallclock_us) const {
+    std::vector<uint8_t> rbsp;
+    rbsp.push_back(SEI_USER_DATA_UNREGISTERED);
+    rbsp.push_back(sizeof(SEI_UUID) + 16);  // payload_size
+    rbsp.insert(rbsp.end(), std::begin(SEI_UUID), std::end(SEI_UUID));
+    append_u64(rbsp, frame_number_);
+    append_u64(rbsp, wallclock_us);
+    rbsp.push_back(0x80);                   // rbsp_trailing_bits
+    append_nal(au, NAL_SEI, rbsp);
+}
+
+void SyntheticH264Source::append_filler(std::vector<uint8_t>& au) const {
+    // Start code + header + trailing byte is the smallest filler NAL unit
+    constexpr size_t filler_overhead = 6;
+    if (au.size() + filler_overhead > target_au_bytes_) {
+        return;
+    }
+
+    au.insert(au.end(), { 0x00, 0x00, 0x00, 0x01, NAL_FILLER });
+    au.insert(au.end(), target_au_bytes_ - au.size() - 1, 0xff);
+    au.push_back(0x80);
+}
+
+} // namespace paladium
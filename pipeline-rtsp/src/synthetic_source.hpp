@@ -0,0 +1,79 @@
+#pragma once
+
+#include <expected>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+namespace paladium {
+
+enum class ResolutionClass { SD360, HD720, FHD1080 };
+
+struct SyntheticConfig {
+    ResolutionClass resolution = ResolutionClass::HD720;
+    uint32_t bitrate_kbps = 2000;   // Target average bitrate, reached with filler NAL units
+    uint32_t gop = 30;              // Frames between IDRs
+    uint32_t fps = 30;
+    uint32_t streams = 1;           // Independent mounts to serve (/cam1 .. /camN)
+    bool embed_sei = true;          // Frame counter + wall-clock timestamp in every access unit
+};
+
+struct FrameSize {
+    uint32_t width;
+    uint32_t height;
+};
+
+struct AccessUnit {
+    std::vector<uint8_t> data;      // Annex B byte-stream, 4-byte start codes
+    uint64_t frame_number;
+    bool keyframe;
+};
+
+std::expected<ResolutionClass, std::string> parse_resolution_class(std::string_view name);
+std::string_view resolution_class_name(ResolutionClass resolution);
+FrameSize frame_size(ResolutionClass resolution);
+
+// Lowest level whose MaxFS, MaxMBPS and MaxBR admit the configuration
+std::expected<uint8_t, std::string> h264_level(const SyntheticConfig& config);
+
+// Produces a valid H.264 (constrained baseline) stream without an encoder:
+// IDR frames are flat grey I_16x16 DC-predicted macroblocks and P frames skip
+// every macroblock, so each picture is assembled from precomputed bitstream
+// pieces. Frame loss and latency can be measured at the receiver from the
+// user_data_unregistered SEI tagged with SEI_UUID.
+class SyntheticH264Source {
+public:
+    static constexpr uint8_t SEI_UUID[16] = {
+        0x70, 0x61, 0x6c, 0x61, 0x64, 0x69, 0x75, 0x6d,   // "paladium"
+        0x2d, 0x73, 0x79, 0x6e, 0x74, 0x68, 0x2d, 0x31    // "-synth-1"
+    };
+
+    explicit SyntheticH264Source(const SyntheticConfig& config);
+
+    // Builds the next access unit; wallclock_us is embedded in the SEI
+    AccessUnit next_access_unit(uint64_t wallclock_us);
+
+    // Makes the next access unit an IDR (e.g. after the pipeline restarts)
+    void force_keyframe() { gop_position_ = 0; }
+
+private:
+    SyntheticConfig config_;
+    uint32_t mb_count_;
+    size_t target_au_bytes_;
+
+    // Static parts of the stream, built once: SPS + PPS, and the IDR slice
+    // for both idr_pic_id values (consecutive IDRs must differ)
+    std::vector<uint8_t> parameter_sets_;
+    std::vector<uint8_t> idr_slices_[2];
+
+    uint64_t frame_number_ = 0;
+    uint32_t gop_position_ = 0;
+    uint32_t idr_count_ = 0;
+
+    std::vector<uint8_t> build_p_slice(uint32_t frame_num) const;
+    void append_sei(std::vector<uint8_t>& au, uint64_t wallclock_us) const;
+    void append_filler(std::vector<uint8_t>& au) const;
+};
+
+} // namespace paladium